@@ -0,0 +1,110 @@
+#include "Client.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t kReadChunkSize = 64 * 1024; ///< Размер блока чтения из сокета.
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error("Error: " + what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+Client::Client(const std::string& socket_path) {
+    sockaddr_un addr{};
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Error: Socket path is too long: " + socket_path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0) {
+        throw systemError("Could not create socket");
+    }
+    if (connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        int saved_errno = errno;
+        close(fd_);
+        errno = saved_errno;
+        throw systemError("Could not connect to " + socket_path);
+    }
+    int flags = fcntl(fd_, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+        int saved_errno = errno;
+        close(fd_);
+        errno = saved_errno;
+        throw systemError("Could not make socket non-blocking");
+    }
+}
+
+Client::~Client() {
+    close(fd_);
+}
+
+void Client::send(const std::string& request) {
+    output_ += request;
+    output_ += '\n';
+}
+
+void Client::flush() {
+    while (output_pos_ < output_.size()) {
+        exchange();
+    }
+    output_.clear();
+    output_pos_ = 0;
+}
+
+std::string Client::receive() {
+    while (true) {
+        size_t end = input_.find('\n', input_pos_);
+        if (end != std::string::npos) {
+            std::string response = input_.substr(input_pos_, end - input_pos_);
+            input_pos_ = end + 1;
+            return response;
+        }
+        exchange();
+    }
+}
+
+void Client::exchange() {
+    bool sending = output_pos_ < output_.size();
+    pollfd fd = {fd_, static_cast<short>(POLLIN | (sending ? POLLOUT : 0)), 0};
+    if (poll(&fd, 1, -1) < 0) {
+        if (errno == EINTR) return;
+        throw systemError("poll failed");
+    }
+
+    if (fd.revents & (POLLIN | POLLHUP | POLLERR)) {
+        if (input_pos_ > 0) {
+            input_.erase(0, input_pos_);
+            input_pos_ = 0;
+        }
+        char buffer[kReadChunkSize];
+        ssize_t received = recv(fd_, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            input_.append(buffer, static_cast<size_t>(received));
+        } else if (received == 0) {
+            throw std::runtime_error("Error: Server closed the connection.");
+        } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+            throw systemError("Could not receive response");
+        }
+    }
+
+    if (sending && (fd.revents & POLLOUT)) {
+        ssize_t sent = ::send(fd_, output_.data() + output_pos_, output_.size() - output_pos_,
+                              MSG_NOSIGNAL);
+        if (sent > 0) {
+            output_pos_ += static_cast<size_t>(sent);
+        } else if (sent < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+            throw systemError("Could not send request");
+        }
+    }
+}
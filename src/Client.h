@@ -0,0 +1,68 @@
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <string>
+
+/**
+ * @class Client
+ * @brief Клиент резидентного сервера, подключающийся через Unix-сокет.
+ *
+ * Запросы накапливаются в буфере и отправляются одним пакетом при вызове flush()
+ * или receive(), что позволяет конвейеризовать несколько запросов за один обмен.
+ * Во время отправки клиент одновременно принимает ответы в свой буфер: сервер
+ * перестаёт читать соединение, на котором скопилось много непрочитанных ответов,
+ * и блокирующая отправка большого пакета иначе привела бы к взаимной блокировке.
+ */
+class Client {
+public:
+    /**
+     * @brief Подключается к серверу.
+     * @param socket_path Путь к файлу Unix-сокета.
+     * @throws std::runtime_error если подключиться не удалось.
+     */
+    explicit Client(const std::string& socket_path);
+
+    /**
+     * @brief Деструктор. Закрывает соединение.
+     */
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    /**
+     * @brief Добавляет запрос в буфер отправки.
+     * @param request Строка запроса без завершающего перевода строки.
+     */
+    void send(const std::string& request);
+
+    /**
+     * @brief Отправляет все накопленные запросы, параллельно принимая ответы.
+     * @throws std::runtime_error при ошибке сокета или если сервер закрыл соединение.
+     */
+    void flush();
+
+    /**
+     * @brief Принимает ответ на очередной отправленный запрос.
+     *
+     * Перед ожиданием ответа отправляет все накопленные запросы.
+     * @return Строка ответа без завершающего перевода строки.
+     * @throws std::runtime_error при ошибке чтения или если сервер закрыл соединение.
+     */
+    std::string receive();
+
+private:
+    int fd_ = -1;           ///< Дескриптор сокета (неблокирующий).
+    std::string output_;    ///< Запросы, ещё не отправленные серверу.
+    size_t output_pos_ = 0; ///< Сколько байт output_ уже отправлено.
+    std::string input_;     ///< Принятые, но ещё не прочитанные ответы.
+    size_t input_pos_ = 0;  ///< Позиция начала следующего ответа в input_.
+
+    /**
+     * @brief Ожидает готовности сокета и выполняет одну порцию приёма и отправки.
+     * @throws std::runtime_error при ошибке сокета или если сервер закрыл соединение.
+     */
+    void exchange();
+};
+
+#endif // CLIENT_H
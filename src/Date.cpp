@@ -1,31 +1,39 @@
 #include "Date.h"
+#include <charconv>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
-#include <vector>
 
 Date::Date() : year(0), month(0), day(0) {}
 Date::Date(int y, int m, int d) : year(y), month(m), day(d) {}
 
 Date Date::fromString(const std::string& date_str) {
-    std::stringstream ss(date_str);
-    std::string segment;
-    std::vector<int> parts;
-
-    while (std::getline(ss, segment, '-')) {
-        try {
-            parts.push_back(std::stoi(segment));
-        } catch (const std::invalid_argument& e) {
+    return fromChars(date_str.data(), date_str.data() + date_str.size());
+}
+
+Date Date::fromChars(const char* first, const char* last) {
+    int parts[3];
+    const char* pos = first;
+    for (int i = 0; i < 3; ++i) {
+        if (i > 0) {
+            if (pos == last || *pos != '-') {
+                throw std::invalid_argument("Invalid date format. Expected YYYY-MM-DD.");
+            }
+            ++pos;
+        }
+        auto result = std::from_chars(pos, last, parts[i]);
+        if (result.ec != std::errc()) {
             throw std::invalid_argument("Invalid number format in date string.");
-        } catch (const std::out_of_range& e) {
-            throw std::invalid_argument("Number out of range in date string.");
         }
+        pos = result.ptr;
     }
-
-    if (parts.size() != 3) {
+    if (pos != last) {
         throw std::invalid_argument("Invalid date format. Expected YYYY-MM-DD.");
     }
 
+    if (parts[0] < 1 || parts[0] > 9999) {
+        throw std::invalid_argument("Invalid year value. Expected 1-9999.");
+    }
     if (parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > 31) {
         throw std::invalid_argument("Invalid month or day value.");
     }
@@ -37,6 +37,16 @@ struct Date {
      */
     static Date fromString(const std::string& date_str);
 
+    /**
+     * @brief Создает объект Date из диапазона символов без промежуточных строк.
+     * @param first Начало диапазона.
+     * @param last Конец диапазона (не включается).
+     * @return Объект Date.
+     * @throws std::invalid_argument если диапазон не является датой «ГГГГ-ММ-ДД»
+     *         или год вне диапазона 1–9999.
+     */
+    static Date fromChars(const char* first, const char* last);
+
     /**
      * @brief Преобразует объект Date в строку.
      * @return Строковое представление даты в формате «ГГГГ-ММ-ДД».
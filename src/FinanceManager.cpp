@@ -1,57 +1,81 @@
 #include "FinanceManager.h"
-#include <algorithm>
+#include "TransactionSchema.h"
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 
 Transaction FinanceManager::addTransaction(const Date& date, double amount,
                                            const std::string& category,
                                            const std::string& description) {
-    Transaction new_trans = {next_id_++, date, amount, category, description};
-    transactions_.push_back(new_trans);
-    return new_trans;
+    return addTransaction(Transaction{0, date, amount, category, description});
+}
+
+Transaction FinanceManager::addTransaction(Transaction trans) {
+    trans.id = next_id_++;
+    index_by_id_[trans.id] = transactions_.size();
+    transactions_.push_back(std::move(trans));
+    return transactions_.back();
 }
 
 bool FinanceManager::editTransaction(size_t id, const Date& new_date, double new_amount,
                                      const std::string& new_category,
                                      const std::string& new_description) {
-    for (auto& trans : transactions_) {
-        if (trans.id == id) {
-            trans.date = new_date;
-            trans.amount = new_amount;
-            trans.category = new_category;
-            trans.description = new_description;
-            return true;
-        }
+    return editTransaction(Transaction{id, new_date, new_amount, new_category, new_description});
+}
+
+bool FinanceManager::editTransaction(const Transaction& trans) {
+    Transaction* existing = findById(trans.id);
+    if (!existing) {
+        return false;
     }
-    return false;
+    *existing = trans;
+    return true;
 }
 
 bool FinanceManager::deleteTransaction(size_t id) {
-    auto it = std::remove_if(transactions_.begin(), transactions_.end(),
-                             [id](const Transaction& trans) { return trans.id == id; });
+    auto found = index_by_id_.find(id);
+    if (found == index_by_id_.end()) {
+        return false;
+    }
 
-    if (it != transactions_.end()) {
-        transactions_.erase(it, transactions_.end());
-        return true;
+    size_t position = found->second;
+    index_by_id_.erase(found);
+    transactions_.erase(transactions_.begin() + position);
+    for (size_t i = position; i < transactions_.size(); ++i) {
+        index_by_id_[transactions_[i].id] = i;
     }
-    return false;
+    return true;
 }
 
 const Transaction* FinanceManager::findTransactionById(size_t id) const {
-    for (const auto& trans : transactions_) {
-        if (trans.id == id) {
-            return &trans;
-        }
-    }
-    return nullptr;
+    auto found = index_by_id_.find(id);
+    return found == index_by_id_.end() ? nullptr : &transactions_[found->second];
+}
+
+Transaction* FinanceManager::findById(size_t id) {
+    auto found = index_by_id_.find(id);
+    return found == index_by_id_.end() ? nullptr : &transactions_[found->second];
 }
 
 const std::vector<Transaction>& FinanceManager::getTransactions() const {
     return transactions_;
 }
 
+Report FinanceManager::generateReport(const Date& start_date, const Date& end_date) const {
+    Report report;
+    for (const auto& trans : transactions_) {
+        if (!(trans.date < start_date) && (trans.date < end_date || trans.date == end_date)) {
+            if (trans.amount > 0) {
+                report.total_income += trans.amount;
+            } else {
+                report.total_expense += trans.amount;
+                report.expenses_by_category[trans.category] += trans.amount;
+            }
+        }
+    }
+    return report;
+}
+
 void FinanceManager::loadFromFile(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -62,51 +86,55 @@ void FinanceManager::loadFromFile(const std::string& filename) {
     }
 
     transactions_.clear();
+    index_by_id_.clear();
     std::string line;
     std::getline(file, line);
 
     while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
         if (line.empty()) continue;
-        std::stringstream ss(line);
-        std::string segment;
-        std::vector<std::string> parts;
-
-        while (std::getline(ss, segment, ',')) {
-            parts.push_back(segment);
+        Transaction trans;
+        bool parsed;
+        try {
+            parsed = TransactionSchema::parseDelimited<TransactionSchema::kCsvSeparator>(
+                line.data(), line.data() + line.size(), trans);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("CSV parsing error in line: " + line + " (" + e.what() +
+                                     ")");
         }
 
-        if (parts.size() != 5) {
+        if (!parsed) {
             throw std::runtime_error("CSV format error: Invalid number of columns in line: " +
                                      line);
         }
-
-        try {
-            Transaction trans;
-            trans.id = std::stoull(parts[0]);
-            trans.date = Date::fromString(parts[1]);
-            trans.amount = std::stod(parts[2]);
-            trans.category = parts[3];
-            trans.description = parts[4];
-            transactions_.push_back(trans);
-        } catch (const std::exception& e) {
-            throw std::runtime_error("CSV parsing error in line: " + line + " (" + e.what() +
-                                     ")");
+        if (!index_by_id_.emplace(trans.id, transactions_.size()).second) {
+            throw std::runtime_error("CSV format error: Duplicate ID in line: " + line);
         }
+        transactions_.push_back(std::move(trans));
     }
     updateNextId();
 }
 
 void FinanceManager::saveToFile(const std::string& filename) const {
+    // Запись формируется целиком до открытия файла, чтобы некорректная транзакция
+    // не оставила вместо данных обрезанный файл.
+    std::string data = TransactionSchema::header<TransactionSchema::kCsvSeparator>();
+    data += '\n';
+    for (const auto& trans : transactions_) {
+        try {
+            TransactionSchema::appendDelimited<TransactionSchema::kCsvSeparator>(data, trans);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Error: Could not save transaction " +
+                                     std::to_string(trans.id) + ": " + e.what());
+        }
+        data += '\n';
+    }
+
     std::ofstream file(filename);
     if (!file.is_open()) {
         throw std::runtime_error("Error: Could not open file for writing: " + filename);
     }
-
-    file << "ID,Date,Amount,Category,Description\n";
-    for (const auto& trans : transactions_) {
-        file << trans.id << "," << trans.date.toString() << "," << trans.amount << ","
-             << trans.category << "," << trans.description << "\n";
-    }
+    file << data;
 }
 
 void FinanceManager::updateNextId() {
@@ -2,10 +2,22 @@
 #define FINANCE_MANAGER_H
 
 #include "Transaction.h"
+#include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+/**
+ * @struct Report
+ * @brief Сводка доходов и расходов за период.
+ */
+struct Report {
+    double total_income = 0.0;                          ///< Сумма доходов за период.
+    double total_expense = 0.0;                         ///< Сумма расходов (отрицательная).
+    std::map<std::string, double> expenses_by_category; ///< Расходы по каждой категории.
+};
+
 /**
  * @class FinanceManager
  * @brief Управляет всеми финансовыми операциями и данными.
@@ -26,6 +38,13 @@ public:
     Transaction addTransaction(const Date& date, double amount, const std::string& category,
                                const std::string& description);
 
+    /**
+     * @brief Добавляет готовую запись, назначая ей новый идентификатор.
+     * @param trans Запись транзакции; поле id игнорируется.
+     * @return Вновь созданный объект транзакции.
+     */
+    Transaction addTransaction(Transaction trans);
+
     /**
      * @brief Редактирует существующую транзакцию.
      * @param id Идентификатор транзакции для редактирования.
@@ -38,8 +57,18 @@ public:
     bool editTransaction(size_t id, const Date& new_date, double new_amount,
                          const std::string& new_category, const std::string& new_description);
 
+    /**
+     * @brief Заменяет существующую транзакцию с тем же идентификатором.
+     * @param trans Новая запись; поле id задаёт редактируемую транзакцию.
+     * @return True, если транзакция была найдена и отредактирована, в противном случае — false.
+     */
+    bool editTransaction(const Transaction& trans);
+
     /**
      * @brief Удаляет транзакцию по ее идентификатору.
+     *
+     * Порядок остальных транзакций сохраняется, поэтому удаление линейно по числу
+     * транзакций, следующих за удаляемой.
      * @param id Идентификатор транзакции для удаления.
      * @return True, если транзакция была найдена и удалена, в противном случае — false.
      */
@@ -59,23 +88,41 @@ public:
      */
     const std::vector<Transaction>& getTransactions() const;
 
+    /**
+     * @brief Формирует отчёт о доходах и расходах за период.
+     * @param start_date Начало периода (включительно).
+     * @param end_date Конец периода (включительно).
+     * @return Сводка по транзакциям, попавшим в период.
+     */
+    Report generateReport(const Date& start_date, const Date& end_date) const;
+
     /**
      * @brief Загружает транзакции из CSV-файла.
      * @param filename Путь к CSV-файлу.
-     * @throws std::runtime_error при ошибках ввода-вывода файла или синтаксического анализа.
+     * @throws std::runtime_error при ошибках ввода-вывода файла, синтаксического анализа
+     *         или повторяющемся идентификаторе.
      */
     void loadFromFile(const std::string& filename);
 
     /**
      * @brief Сохраняет все транзакции в CSV-файл.
      * @param filename Путь к CSV-файлу.
-     * @throws std::runtime_error при ошибках ввода-вывода файла.
+     * @throws std::runtime_error при ошибках ввода-вывода файла или если текст транзакции
+     *         содержит разделители; в последнем случае файл не изменяется.
      */
     void saveToFile(const std::string& filename) const;
 
 private:
     std::vector<Transaction> transactions_; ///< Контейнер для всех транзакций.
     size_t next_id_ = 1;                    ///< Счетчик для генерации уникальных идентификаторов транзакций.
+    std::unordered_map<size_t, size_t> index_by_id_; ///< Позиция транзакции по идентификатору.
+
+    /**
+     * @brief Находит позицию транзакции по ее идентификатору.
+     * @param id Идентификатор транзакции.
+     * @return Указатель на транзакцию, если найден, в противном случае — nullptr.
+     */
+    Transaction* findById(size_t id);
 
     /**
      * @brief Обновляет следующий доступный идентификатор на основе текущих транзакций.
@@ -0,0 +1,118 @@
+#include "Client.h"
+#include "RequestHandler.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Нагрузочный тест резидентного сервера: отправляет запросы FIND пакетами заданной
+// глубины и измеряет пропускную способность и время обмена одним пакетом.
+// Тест только читает данные: ищется существующая транзакция (заданная аргументом
+// или первая найденная среди небольших идентификаторов), журнал не изменяется.
+
+namespace {
+
+std::string expectOk(const std::string& response) {
+    if (response.compare(0, 2, "OK") != 0) {
+        throw std::runtime_error("Unexpected response: " + response);
+    }
+    return response;
+}
+
+const size_t kMaxProbedId = 1024; ///< Сколько идентификаторов перебирать в поисках записи.
+
+// Возвращает первый существующий идентификатор из 1..kMaxProbedId; запросы отправляются
+// одним пакетом, поэтому поиск занимает один обмен.
+std::string findExistingId(Client& client) {
+    const char sep = RequestHandler::kFieldSeparator;
+    for (size_t id = 1; id <= kMaxProbedId; ++id) {
+        client.send(std::string("FIND") + sep + std::to_string(id));
+    }
+    std::string found;
+    for (size_t id = 1; id <= kMaxProbedId; ++id) {
+        std::string response = client.receive();
+        if (found.empty() && response.compare(0, 3, "OK" + std::string(1, sep)) == 0) {
+            found = std::to_string(id);
+        }
+    }
+    if (found.empty()) {
+        throw std::runtime_error("No transaction found among IDs 1-" +
+                                 std::to_string(kMaxProbedId) + "; pass an existing ID.");
+    }
+    return found;
+}
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 5) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <socket_path> [requests=100000] [pipeline=64] [transaction_id]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        const std::string socket_path = argv[1];
+        const size_t total = argc > 2 ? std::stoull(argv[2]) : 100000;
+        const size_t depth = std::max<size_t>(1, argc > 3 ? std::stoull(argv[3]) : 64);
+        const char sep = RequestHandler::kFieldSeparator;
+
+        Client client(socket_path);
+
+        std::string id;
+        if (argc > 4) {
+            id = argv[4];
+            client.send(std::string("FIND") + sep + id);
+            expectOk(client.receive());
+        } else {
+            id = findExistingId(client);
+        }
+        const std::string request = std::string("FIND") + sep + id;
+
+        std::vector<double> batch_us;
+        batch_us.reserve(total / depth + 1);
+        auto started = std::chrono::steady_clock::now();
+
+        size_t done = 0;
+        while (done < total) {
+            size_t batch = std::min(depth, total - done);
+            auto batch_started = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < batch; ++i) {
+                client.send(request);
+            }
+            for (size_t i = 0; i < batch; ++i) {
+                expectOk(client.receive());
+            }
+            auto batch_finished = std::chrono::steady_clock::now();
+            batch_us.push_back(
+                std::chrono::duration<double, std::micro>(batch_finished - batch_started).count());
+            done += batch;
+        }
+
+        double elapsed_s =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        std::cout << "Requests:            " << total << "\n";
+        std::cout << "Pipeline depth:      " << depth << "\n";
+        std::cout << "Transaction ID:      " << id << "\n";
+        std::cout << "Elapsed:             " << elapsed_s << " s\n";
+        std::cout << "Throughput:          " << total / elapsed_s << " req/s\n";
+        std::cout << "Mean per request:    " << elapsed_s * 1e6 / total << " us\n";
+        std::cout << "Batch round trip p50: " << percentile(batch_us, 0.50) << " us\n";
+        std::cout << "Batch round trip p99: " << percentile(batch_us, 0.99) << " us\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "RequestHandler.h"
+#include "TransactionSchema.h"
+#include <stdexcept>
+
+namespace {
+
+std::string errorResponse(const std::string& message) {
+    return std::string("ERR") + RequestHandler::kFieldSeparator + message;
+}
+
+std::vector<std::string> splitRequest(const std::string& request, size_t count) {
+    std::vector<std::string> fields = RequestHandler::splitFields(request);
+    if (fields.size() != count) {
+        throw std::invalid_argument("Invalid number of fields for " + fields[0]);
+    }
+    return fields;
+}
+
+// Разбирает поля записи, следующие за командой, по схеме TransactionSchema,
+// начиная со столбца FirstField, поэтому новый столбец не требует изменений здесь.
+template <size_t FirstField>
+Transaction parseRecord(const std::string& request, size_t command_end) {
+    Transaction trans{};
+    if (command_end == std::string::npos ||
+        !TransactionSchema::parseDelimited<RequestHandler::kFieldSeparator, FirstField>(
+            request.data() + command_end + 1, request.data() + request.size(), trans)) {
+        throw std::invalid_argument("Invalid number of fields for " +
+                                    request.substr(0, command_end));
+    }
+    return trans;
+}
+
+// В отличие от std::stod/std::stoull, поле должно быть разобрано целиком:
+// «12abc» и «-1» в качестве идентификатора отклоняются.
+template <typename T> T parseField(const std::string& field) {
+    T value;
+    TransactionSchema::parseValue(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+template <typename T> void appendField(std::string& out, const T& value) {
+    out += RequestHandler::kFieldSeparator;
+    TransactionSchema::appendValue(out, value);
+}
+
+} // namespace
+
+RequestHandler::RequestHandler(FinanceManager& manager, const std::string& filename)
+    : manager_(manager), filename_(filename) {}
+
+std::vector<std::string> RequestHandler::splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t end = line.find(kFieldSeparator, start);
+        if (end == std::string::npos) {
+            fields.push_back(line.substr(start));
+            return fields;
+        }
+        fields.push_back(line.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+std::string RequestHandler::handle(const std::string& request) {
+    size_t command_end = request.find(kFieldSeparator);
+    std::string command = request.substr(0, command_end);
+    std::string response = "OK";
+
+    try {
+        if (command == "ADD") {
+            Transaction trans = manager_.addTransaction(
+                parseRecord<TransactionSchema::kFirstDataField>(request, command_end));
+            appendField(response, trans.id);
+        } else if (command == "EDIT") {
+            if (!manager_.editTransaction(parseRecord<0>(request, command_end))) {
+                return errorResponse("Transaction not found");
+            }
+        } else if (command == "DEL") {
+            std::vector<std::string> fields = splitRequest(request, 2);
+            if (!manager_.deleteTransaction(parseField<size_t>(fields[1]))) {
+                return errorResponse("Transaction not found");
+            }
+        } else if (command == "FIND") {
+            std::vector<std::string> fields = splitRequest(request, 2);
+            const Transaction* trans =
+                manager_.findTransactionById(parseField<size_t>(fields[1]));
+            if (!trans) {
+                return errorResponse("Transaction not found");
+            }
+            response += kFieldSeparator;
+            TransactionSchema::appendDelimited<kFieldSeparator>(response, *trans);
+        } else if (command == "REPORT") {
+            std::vector<std::string> fields = splitRequest(request, 3);
+            Report report =
+                manager_.generateReport(parseField<Date>(fields[1]), parseField<Date>(fields[2]));
+            appendField(response, report.total_income);
+            appendField(response, report.total_expense);
+            for (const auto& pair : report.expenses_by_category) {
+                appendField(response, pair.first);
+                appendField(response, pair.second);
+            }
+        } else if (command == "SAVE") {
+            splitRequest(request, 1);
+            save();
+        } else if (command == "PING") {
+            // Проверка доступности: ответ OK без данных.
+        } else if (command == "SHUTDOWN") {
+            // Сохраняем до ответа, чтобы OK означал, что данные уже на диске.
+            // При ошибке сохранения сервер продолжает работу.
+            save();
+            shutdown_requested_ = true;
+        } else {
+            return errorResponse("Unknown command: " + command);
+        }
+    } catch (const std::exception& e) {
+        return errorResponse(e.what());
+    }
+    return response;
+}
+
+void RequestHandler::save() const {
+    manager_.saveToFile(filename_);
+}
+
+bool RequestHandler::shutdownRequested() const {
+    return shutdown_requested_;
+}
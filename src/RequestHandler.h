@@ -0,0 +1,71 @@
+#ifndef REQUEST_HANDLER_H
+#define REQUEST_HANDLER_H
+
+#include "FinanceManager.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class RequestHandler
+ * @brief Выполняет запросы протокола резидентного режима над FinanceManager.
+ *
+ * Запрос и ответ занимают ровно одну строку, поля разделяются символом табуляции.
+ * Записи передаются столбцами TransactionSchema в порядке схемы (сейчас
+ * `<id> <дата> <сумма> <категория> <описание>`). Поддерживаемые запросы:
+ * - `ADD  <запись без id>` → `OK <id>`
+ * - `EDIT <запись>` → `OK`
+ * - `DEL  <id>` → `OK`
+ * - `FIND <id>` → `OK <запись>`
+ * - `REPORT <начало> <конец>` → `OK <доходы> <расходы> [<категория> <расходы>]...`
+ * - `SAVE` → `OK` (запись данных в файл)
+ * - `PING` → `OK`
+ * - `SHUTDOWN` → `OK` (данные сохранены, сервер останавливается; запросы, уже принятые
+ *   сервером после SHUTDOWN, получают `ERR Shutting down`, новые не читаются)
+ *
+ * При ошибке возвращается `ERR <сообщение>`. Поскольку каждому запросу соответствует
+ * одна строка ответа, клиент может отправлять запросы пакетами, не дожидаясь ответов.
+ */
+class RequestHandler {
+public:
+    static constexpr char kFieldSeparator = '\t'; ///< Разделитель полей запроса и ответа.
+
+    /**
+     * @brief Конструктор.
+     * @param manager Менеджер, над которым выполняются запросы.
+     * @param filename Путь к CSV-файлу для запросов SAVE и SHUTDOWN.
+     */
+    RequestHandler(FinanceManager& manager, const std::string& filename);
+
+    /**
+     * @brief Выполняет один запрос.
+     * @param request Строка запроса без завершающего перевода строки.
+     * @return Строка ответа без завершающего перевода строки.
+     */
+    std::string handle(const std::string& request);
+
+    /**
+     * @brief Сохраняет данные менеджера в файл.
+     * @throws std::runtime_error при ошибках ввода-вывода файла.
+     */
+    void save() const;
+
+    /**
+     * @brief Проверяет, был ли получен запрос SHUTDOWN.
+     * @return True, если серверу следует завершить работу.
+     */
+    bool shutdownRequested() const;
+
+    /**
+     * @brief Разбивает строку на поля по разделителю протокола.
+     * @param line Строка запроса или ответа.
+     * @return Вектор полей (пустые поля сохраняются).
+     */
+    static std::vector<std::string> splitFields(const std::string& line);
+
+private:
+    FinanceManager& manager_;        ///< Менеджер с данными.
+    std::string filename_;           ///< Путь к CSV-файлу.
+    bool shutdown_requested_ = false; ///< Флаг запроса на остановку.
+};
+
+#endif // REQUEST_HANDLER_H
@@ -0,0 +1,305 @@
+#include "Server.h"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t kReadChunkSize = 64 * 1024;       ///< Размер блока чтения из сокета.
+const size_t kMaxRequestLength = 64 * 1024;    ///< Предельная длина одной строки запроса.
+const size_t kMaxPendingOutput = 1024 * 1024;  ///< Предел неотправленных ответов соединения.
+const int kShutdownFlushTimeoutMs = 1000;      ///< Время на отправку ответов при остановке.
+
+volatile std::sig_atomic_t g_stop_signal = 0;
+volatile std::sig_atomic_t g_wake_fd = -1; ///< Записывающий конец канала пробуждения.
+
+// Сигнал может прийти между проверкой флага и входом в poll(), поэтому обработчик
+// дополнительно пишет байт в канал, который poll() отслеживает (self-pipe).
+void onStopSignal(int) {
+    int saved_errno = errno;
+    g_stop_signal = 1;
+    if (g_wake_fd >= 0) {
+        ssize_t ignored = write(g_wake_fd, "x", 1);
+        (void)ignored;
+    }
+    errno = saved_errno;
+}
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error("Error: " + what + ": " + std::strerror(errno));
+}
+
+sockaddr_un makeAddress(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Error: Socket path is too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw systemError("Could not make socket non-blocking");
+    }
+}
+
+} // namespace
+
+Server::Server(RequestHandler& handler, const std::string& socket_path)
+    : handler_(handler), socket_path_(socket_path) {
+    listen();
+}
+
+Server::~Server() {
+    g_wake_fd = -1;
+    for (int fd : wake_fds_) {
+        if (fd >= 0) close(fd);
+    }
+    for (const auto& conn : connections_) {
+        close(conn.fd);
+    }
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        unlink(socket_path_.c_str());
+    }
+}
+
+void Server::listen() {
+    sockaddr_un addr = makeAddress(socket_path_);
+
+    // Файл сокета мог остаться после аварийного завершения; удаляем его, только если
+    // это действительно сокет и на нём никто не слушает.
+    struct stat info {};
+    if (lstat(socket_path_.c_str(), &info) == 0 && !S_ISSOCK(info.st_mode)) {
+        throw std::runtime_error("Error: Socket path exists and is not a socket: " +
+                                 socket_path_);
+    }
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe >= 0) {
+        bool in_use = connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+        close(probe);
+        if (in_use) {
+            throw std::runtime_error("Error: Another server is already listening on " +
+                                     socket_path_);
+        }
+    }
+    unlink(socket_path_.c_str());
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        throw systemError("Could not create socket");
+    }
+    // Конструктор, бросивший исключение, не вызывает деструктор, поэтому освобождаем
+    // ресурсы здесь.
+    auto fail = [this](const std::string& what, bool bound) {
+        std::runtime_error error = systemError(what);
+        close(listen_fd_);
+        listen_fd_ = -1;
+        if (bound) unlink(socket_path_.c_str());
+        return error;
+    };
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throw fail("Could not bind socket " + socket_path_, false);
+    }
+    if (::listen(listen_fd_, SOMAXCONN) < 0) {
+        throw fail("Could not listen on socket " + socket_path_, true);
+    }
+    int flags = fcntl(listen_fd_, F_GETFL, 0);
+    if (flags < 0 || fcntl(listen_fd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw fail("Could not make socket non-blocking", true);
+    }
+}
+
+void Server::run() {
+    if (wake_fds_[0] < 0) {
+        if (pipe(wake_fds_) < 0) {
+            throw systemError("Could not create wake-up pipe");
+        }
+        setNonBlocking(wake_fds_[0]);
+        setNonBlocking(wake_fds_[1]);
+    }
+    g_wake_fd = wake_fds_[1];
+
+    struct sigaction action {};
+    action.sa_handler = onStopSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+    g_stop_signal = 0;
+
+    std::vector<pollfd> fds;
+    while (!g_stop_signal && !handler_.shutdownRequested()) {
+        fds.clear();
+        fds.push_back({listen_fd_, POLLIN, 0});
+        fds.push_back({wake_fds_[0], POLLIN, 0});
+        for (const auto& conn : connections_) {
+            // Клиент, не читающий ответы, перестаёт опрашиваться на чтение, пока не
+            // разберёт очередь, иначе его ответы копились бы без ограничений.
+            short events = 0;
+            if (!conn.closing && conn.output.size() < kMaxPendingOutput) events |= POLLIN;
+            if (!conn.output.empty()) events |= POLLOUT;
+            fds.push_back({conn.fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("poll failed");
+        }
+
+        // Соединения, принятые на этой итерации, в fds не попали и будут опрошены на следующей.
+        size_t polled = connections_.size();
+        if (fds[0].revents & POLLIN) {
+            acceptConnections();
+        }
+        if (fds[1].revents & POLLIN) {
+            char drain[64];
+            while (read(wake_fds_[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        for (size_t i = polled; i-- > 0;) {
+            Connection& conn = connections_[i];
+            short revents = fds[i + 2].revents;
+            bool keep = !(revents & POLLERR);
+            if (keep && (revents & (POLLIN | POLLHUP)) && conn.output.size() < kMaxPendingOutput) {
+                keep = readRequests(conn);
+            }
+            if (keep && !conn.output.empty()) {
+                keep = writeResponses(conn) && processRequests(conn);
+            }
+            if (keep && conn.closing && conn.output.empty() &&
+                conn.input.find('\n') == std::string::npos) {
+                keep = false;
+            }
+            if (!keep) {
+                close(conn.fd);
+                connections_.erase(connections_.begin() + i);
+            }
+        }
+    }
+
+    g_wake_fd = -1;
+
+    // После SHUTDOWN данные уже сохранены обработчиком; при остановке сигналом сохраняем
+    // до отправки ответов, чтобы медленный клиент не мог задержать сохранение.
+    if (!handler_.shutdownRequested()) {
+        handler_.save();
+    }
+    flushOnShutdown();
+}
+
+void Server::flushOnShutdown() {
+    if (handler_.shutdownRequested()) {
+        for (auto& conn : connections_) {
+            processRequests(conn);
+        }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(kShutdownFlushTimeoutMs);
+    std::vector<pollfd> fds;
+    while (true) {
+        fds.clear();
+        for (const auto& conn : connections_) {
+            if (!conn.output.empty()) fds.push_back({conn.fd, POLLOUT, 0});
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (fds.empty() || remaining.count() <= 0) return;
+
+        if (poll(fds.data(), fds.size(), static_cast<int>(remaining.count())) < 0 &&
+            errno != EINTR) {
+            return;
+        }
+        for (auto& conn : connections_) {
+            if (!conn.output.empty() && !writeResponses(conn)) {
+                conn.output.clear();
+            }
+        }
+    }
+}
+
+void Server::acceptConnections() {
+    while (true) {
+        int fd = accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+            throw systemError("accept failed");
+        }
+        setNonBlocking(fd);
+        connections_.push_back({fd, {}, {}});
+    }
+}
+
+bool Server::readRequests(Connection& conn) {
+    char buffer[kReadChunkSize];
+    ssize_t received;
+    do {
+        received = recv(conn.fd, buffer, sizeof(buffer), 0);
+    } while (received < 0 && errno == EINTR);
+
+    if (received > 0) {
+        conn.input.append(buffer, static_cast<size_t>(received));
+    } else if (received == 0) {
+        conn.closing = true;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        return false;
+    }
+    return processRequests(conn);
+}
+
+bool Server::processRequests(Connection& conn) {
+    size_t start = 0;
+    size_t end;
+    // После SHUTDOWN уже принятые запросы получают отказ, а не остаются без ответа;
+    // их объём ограничен прочитанными данными, поэтому предел очереди не проверяется.
+    while ((handler_.shutdownRequested() || conn.output.size() < kMaxPendingOutput) &&
+           (end = conn.input.find('\n', start)) != std::string::npos) {
+        if (handler_.shutdownRequested()) {
+            conn.output += "ERR";
+            conn.output += RequestHandler::kFieldSeparator;
+            conn.output += "Shutting down";
+        } else {
+            size_t length = end - start;
+            if (length > 0 && conn.input[end - 1] == '\r') --length;
+            conn.output += handler_.handle(conn.input.substr(start, length));
+        }
+        conn.output += '\n';
+        start = end + 1;
+    }
+    conn.input.erase(0, start);
+
+    // Ограничение касается только незавершённого запроса в конце буфера.
+    size_t last_newline = conn.input.rfind('\n');
+    size_t partial_start = last_newline == std::string::npos ? 0 : last_newline + 1;
+    return conn.input.size() - partial_start <= kMaxRequestLength;
+}
+
+bool Server::writeResponses(Connection& conn) {
+    size_t sent_total = 0;
+    while (sent_total < conn.output.size()) {
+        ssize_t sent = send(conn.fd, conn.output.data() + sent_total,
+                            conn.output.size() - sent_total, MSG_NOSIGNAL);
+        if (sent > 0) {
+            sent_total += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    conn.output.erase(0, sent_total);
+    return true;
+}
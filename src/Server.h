@@ -0,0 +1,101 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "RequestHandler.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class Server
+ * @brief Резидентный сервер, обслуживающий запросы через локальный Unix-сокет.
+ *
+ * Данные загружаются один раз при запуске, после чего запросы выполняются в памяти.
+ * Сервер однопоточный: все соединения обслуживаются одним циклом poll(), что избавляет
+ * от блокировок вокруг FinanceManager. Запросы одного соединения выполняются строго
+ * по порядку, поэтому клиент может отправлять их пакетами (конвейером).
+ */
+class Server {
+public:
+    /**
+     * @brief Конструктор.
+     * @param handler Обработчик запросов.
+     * @param socket_path Путь к файлу Unix-сокета.
+     * @throws std::runtime_error если сокет уже занят другим сервером или недоступен.
+     */
+    Server(RequestHandler& handler, const std::string& socket_path);
+
+    /**
+     * @brief Деструктор. Закрывает соединения и удаляет файл сокета.
+     */
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief Запускает цикл обслуживания.
+     *
+     * Возвращает управление после запроса SHUTDOWN (данные к этому моменту уже сохранены
+     * обработчиком) или сигнала SIGINT/SIGTERM (данные сохраняются перед выходом).
+     * Неотправленные ответы дописываются с ограничением по времени.
+     * @throws std::runtime_error при ошибках сокета или сохранения данных.
+     */
+    void run();
+
+private:
+    /**
+     * @struct Connection
+     * @brief Состояние одного клиентского соединения.
+     */
+    struct Connection {
+        int fd;                  ///< Дескриптор сокета.
+        std::string input;       ///< Принятые, но ещё не обработанные данные.
+        std::string output;      ///< Ответы, ещё не отправленные клиенту.
+        bool closing = false;    ///< Клиент закрыл свою сторону; закрыть после отправки ответов.
+    };
+
+    RequestHandler& handler_;             ///< Обработчик запросов.
+    std::string socket_path_;             ///< Путь к файлу сокета.
+    int listen_fd_ = -1;                  ///< Слушающий сокет.
+    int wake_fds_[2] = {-1, -1};          ///< Канал, будящий poll() при получении сигнала.
+    std::vector<Connection> connections_; ///< Активные соединения.
+
+    /**
+     * @brief Создаёт слушающий сокет.
+     * @throws std::runtime_error если сокет уже занят другим сервером или недоступен.
+     */
+    void listen();
+
+    /**
+     * @brief Принимает все ожидающие соединения.
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Читает очередной блок данных из соединения и выполняет принятые запросы.
+     * @param conn Соединение.
+     * @return False, если соединение следует закрыть.
+     */
+    bool readRequests(Connection& conn);
+
+    /**
+     * @brief Выполняет полностью принятые запросы, пока очередь ответов не превысит предел.
+     * @param conn Соединение.
+     * @return False, если незавершённый запрос превысил допустимую длину.
+     */
+    bool processRequests(Connection& conn);
+
+    /**
+     * @brief Дописывает накопленные ответы при остановке, не дольше заданного времени.
+     */
+    void flushOnShutdown();
+
+    /**
+     * @brief Отправляет накопленные ответы, пока сокет принимает данные.
+     * @param conn Соединение.
+     * @return False, если соединение следует закрыть.
+     */
+    bool writeResponses(Connection& conn);
+};
+
+#endif // SERVER_H
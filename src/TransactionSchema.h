@@ -0,0 +1,288 @@
+#ifndef TRANSACTION_SCHEMA_H
+#define TRANSACTION_SCHEMA_H
+
+#include "Transaction.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+/**
+ * @struct FieldDescriptor
+ * @brief Описание одного столбца записи Transaction.
+ * @tparam T Тип поля.
+ */
+template <typename T> struct FieldDescriptor {
+    T Transaction::*member;  ///< Указатель на поле структуры.
+    const char* column_name; ///< Имя столбца в заголовке CSV.
+    const char* label;       ///< Подпись поля при выводе на экран.
+};
+
+/**
+ * @brief Создает описание столбца с выводом типа поля.
+ * @param member Указатель на поле Transaction.
+ * @param column_name Имя столбца в заголовке CSV.
+ * @param label Подпись поля при выводе на экран.
+ * @return Описание столбца.
+ */
+template <typename T>
+constexpr FieldDescriptor<T> field(T Transaction::*member, const char* column_name,
+                                   const char* label) {
+    return {member, column_name, label};
+}
+
+/**
+ * @brief Схема записи Transaction и кодеки, генерируемые по ней на этапе компиляции.
+ *
+ * Разбор, сериализация и вывод разворачиваются в последовательность вызовов для
+ * каждого столбца, поэтому в горячих циклах нет ни выбора по номеру столбца,
+ * ни подсчёта столбцов, ни промежуточных строк.
+ */
+namespace TransactionSchema {
+
+/// Столбцы в порядке следования. Новый столбец — это поле в Transaction и строка здесь.
+constexpr auto kFields = std::make_tuple(field(&Transaction::id, "ID", "ID"),
+                                         field(&Transaction::date, "Date", "Date"),
+                                         field(&Transaction::amount, "Amount", "Amount"),
+                                         field(&Transaction::category, "Category", "Category"),
+                                         field(&Transaction::description, "Description", "Desc"));
+
+constexpr size_t kFieldCount = std::tuple_size_v<decltype(kFields)>; ///< Число столбцов.
+constexpr size_t kFirstDataField = 1; ///< Первый столбец после ID, задаваемый пользователем.
+constexpr char kCsvSeparator = ',';                                  ///< Разделитель CSV.
+
+/// Символы, недопустимые в текстовых полях: разделители всех форматов записи и переводы
+/// строк. Экранирование не поддерживается, поэтому такие значения отклоняются.
+constexpr const char* kForbiddenTextChars = ",\t\r\n";
+
+/**
+ * @brief Проверяет, может ли текст быть записан в любом формате без потери разметки.
+ * @param first Начало текста.
+ * @param last Конец текста.
+ * @return True, если текст не содержит разделителей и переводов строк.
+ */
+inline bool isValidText(const char* first, const char* last) {
+    return std::string_view(first, static_cast<size_t>(last - first))
+               .find_first_of(kForbiddenTextChars) == std::string_view::npos;
+}
+
+/**
+ * @brief Проверяет, может ли текст быть записан в любом формате без потери разметки.
+ * @param text Текст.
+ * @return True, если текст не содержит разделителей и переводов строк.
+ */
+inline bool isValidText(const std::string& text) {
+    return isValidText(text.data(), text.data() + text.size());
+}
+
+/**
+ * @brief Кодеки значений отдельных полей.
+ *
+ * parseValue разбирает диапазон символов целиком и бросает std::invalid_argument,
+ * если значение некорректно или за ним следуют лишние символы. appendValue дописывает
+ * значение в конец строки; суммы записываются в кратчайшем виде без потери точности.
+ * Текст, не прошедший isValidText, отклоняется в обоих направлениях, поэтому
+ * записанная строка всегда читается обратно.
+ */
+///@{
+inline void parseValue(const char* first, const char* last, size_t& value) {
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last) {
+        throw std::invalid_argument("Invalid ID value.");
+    }
+}
+
+// Вещественные std::from_chars/std::to_chars есть не во всех стандартных библиотеках
+// (libstdc++ — с GCC 11, libc++ Apple — нет). Запасной путь использует strtod/snprintf;
+// приложение не вызывает setlocale, поэтому действует локаль «C» с точкой в дробях.
+inline void parseValue(const char* first, const char* last, double& value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last) {
+        throw std::invalid_argument("Invalid amount value.");
+    }
+#else
+    char buffer[64];
+    size_t length = static_cast<size_t>(last - first);
+    if (length == 0 || length >= sizeof(buffer) || first[0] == ' ' || first[0] == '+') {
+        throw std::invalid_argument("Invalid amount value.");
+    }
+    std::memcpy(buffer, first, length);
+    buffer[length] = '\0';
+    char* end;
+    value = std::strtod(buffer, &end);
+    if (end != buffer + length) {
+        throw std::invalid_argument("Invalid amount value.");
+    }
+#endif
+    // nan и inf разбираются обоими путями, но сделали бы бессмысленными итоги отчётов.
+    if (!std::isfinite(value)) {
+        throw std::invalid_argument("Amount must be a finite number.");
+    }
+}
+
+inline void parseValue(const char* first, const char* last, Date& value) {
+    value = Date::fromChars(first, last);
+}
+
+inline void parseValue(const char* first, const char* last, std::string& value) {
+    if (!isValidText(first, last)) {
+        throw std::invalid_argument("Text fields must not contain commas, tabs or line breaks.");
+    }
+    value.assign(first, last);
+}
+
+inline void appendValue(std::string& out, size_t value) {
+    char buffer[24];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+inline void appendValue(std::string& out, double value) {
+    // Кратчайшее представление, которое читается обратно без потери точности.
+    char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+#else
+    int length = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+        length = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (std::strtod(buffer, nullptr) == value) break;
+    }
+    out.append(buffer, static_cast<size_t>(length));
+#endif
+}
+
+inline void appendValue(std::string& out, const Date& value) {
+    // Рассчитан на любой int в году (11 символов) и «-ММ-ДД», хотя fromChars
+    // допускает только годы 1–9999: Date можно собрать и конструктором.
+    char buffer[11 + 6];
+    char* pos = std::to_chars(buffer, buffer + sizeof(buffer), value.year).ptr;
+    *pos++ = '-';
+    *pos++ = static_cast<char>('0' + value.month / 10);
+    *pos++ = static_cast<char>('0' + value.month % 10);
+    *pos++ = '-';
+    *pos++ = static_cast<char>('0' + value.day / 10);
+    *pos++ = static_cast<char>('0' + value.day % 10);
+    out.append(buffer, pos);
+}
+
+inline void appendValue(std::string& out, const std::string& value) {
+    if (!isValidText(value)) {
+        throw std::invalid_argument("Text fields must not contain commas, tabs or line breaks.");
+    }
+    out += value;
+}
+///@}
+
+namespace detail {
+
+template <char Separator, size_t I>
+bool parseField(const char*& pos, const char* last, Transaction& trans) {
+    auto& value = trans.*std::get<I>(kFields).member;
+    if constexpr (I + 1 < kFieldCount) {
+        auto end = static_cast<const char*>(std::memchr(pos, Separator, last - pos));
+        if (!end) return false;
+        parseValue(pos, end, value);
+        pos = end + 1;
+    } else {
+        if (std::memchr(pos, Separator, last - pos)) return false;
+        parseValue(pos, last, value);
+    }
+    return true;
+}
+
+template <char Separator, size_t FirstField, size_t... I>
+bool parseFields(const char* first, const char* last, Transaction& trans,
+                 std::index_sequence<I...>) {
+    const char* pos = first;
+    return (parseField<Separator, FirstField + I>(pos, last, trans) && ...);
+}
+
+template <char Separator, size_t I>
+void appendField(std::string& out, const Transaction& trans) {
+    if constexpr (I > 0) out += Separator;
+    appendValue(out, trans.*std::get<I>(kFields).member);
+}
+
+template <char Separator, size_t... I>
+void appendFields(std::string& out, const Transaction& trans, std::index_sequence<I...>) {
+    (appendField<Separator, I>(out, trans), ...);
+}
+
+template <char Separator, size_t I> void appendColumnName(std::string& out) {
+    if constexpr (I > 0) out += Separator;
+    out += std::get<I>(kFields).column_name;
+}
+
+template <char Separator, size_t... I> std::string header(std::index_sequence<I...>) {
+    std::string out;
+    (appendColumnName<Separator, I>(out), ...);
+    return out;
+}
+
+template <size_t... I>
+void print(std::ostream& os, const Transaction& trans, std::index_sequence<I...>) {
+    ((os << (I > 0 ? ", " : "") << std::get<I>(kFields).label << ": "
+         << trans.*std::get<I>(kFields).member),
+     ...);
+}
+
+} // namespace detail
+
+/**
+ * @brief Разбирает запись с разделителем полей.
+ * @tparam Separator Разделитель полей.
+ * @tparam FirstField Первый разбираемый столбец; предшествующие поля не изменяются
+ *         (например, kFirstDataField для записи без ID).
+ * @param first Начало записи (без перевода строки).
+ * @param last Конец записи.
+ * @param trans Запись для заполнения.
+ * @return False, если число полей не совпадает со схемой.
+ * @throws std::invalid_argument если значение поля некорректно.
+ */
+template <char Separator, size_t FirstField = 0>
+bool parseDelimited(const char* first, const char* last, Transaction& trans) {
+    static_assert(FirstField < kFieldCount, "FirstField is out of range");
+    return detail::parseFields<Separator, FirstField>(
+        first, last, trans, std::make_index_sequence<kFieldCount - FirstField>());
+}
+
+/**
+ * @brief Дописывает запись с разделителем полей в конец строки.
+ * @tparam Separator Разделитель полей.
+ * @param out Строка-приёмник.
+ * @param trans Запись.
+ * @throws std::invalid_argument если текстовое поле не проходит isValidText.
+ */
+template <char Separator> void appendDelimited(std::string& out, const Transaction& trans) {
+    detail::appendFields<Separator>(out, trans, std::make_index_sequence<kFieldCount>());
+}
+
+/**
+ * @brief Формирует строку заголовка из имён столбцов.
+ * @tparam Separator Разделитель полей.
+ * @return Заголовок без перевода строки.
+ */
+template <char Separator> std::string header() {
+    return detail::header<Separator>(std::make_index_sequence<kFieldCount>());
+}
+
+/**
+ * @brief Выводит запись в читаемом виде «Подпись: значение, ...».
+ * @param os Выходной поток.
+ * @param trans Запись.
+ */
+inline void print(std::ostream& os, const Transaction& trans) {
+    detail::print(os, trans, std::make_index_sequence<kFieldCount>());
+}
+
+} // namespace TransactionSchema
+
+#endif // TRANSACTION_SCHEMA_H
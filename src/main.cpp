@@ -1,12 +1,19 @@
 #include "FinanceManager.h"
+#include "TransactionSchema.h"
 #include <iostream>
 #include <limits>
-#include <map>
+#include <vector>
+
+#ifdef FINANCE_WITH_SERVER
+#include "Client.h"
+#include "RequestHandler.h"
+#include "Server.h"
+#endif
 
 // --- Вспомогательные функции ---
 void printTransaction(const Transaction& trans) {
-    std::cout << "ID: " << trans.id << ", Date: " << trans.date << ", Amount: " << trans.amount
-              << ", Category: " << trans.category << ", Desc: " << trans.description << std::endl;
+    TransactionSchema::print(std::cout, trans);
+    std::cout << std::endl;
 }
 
 template <typename T> T getValidatedInput(const std::string& prompt) {
@@ -38,10 +45,15 @@ Date getDateInput(const std::string& prompt) {
 }
 
 std::string getStringInput(const std::string& prompt) {
-    std::string value;
-    std::cout << prompt;
-    std::getline(std::cin, value);
-    return value;
+    while (true) {
+        std::string value;
+        std::cout << prompt;
+        std::getline(std::cin, value);
+        if (TransactionSchema::isValidText(value)) {
+            return value;
+        }
+        std::cout << "Error: Text must not contain commas or tabs. Please try again." << std::endl;
+    }
 }
 
 // --- Функции пользовательского интерфейса ---
@@ -98,30 +110,17 @@ void generateReportUI(const FinanceManager& manager) {
     Date start_date = getDateInput("Enter start date (YYYY-MM-DD): ");
     Date end_date = getDateInput("Enter end date (YYYY-MM-DD): ");
 
-    double total_income = 0.0;
-    double total_expense = 0.0;
-    std::map<std::string, double> expenses_by_category;
-
-    for (const auto& trans : manager.getTransactions()) {
-        if (!(trans.date < start_date) && (trans.date < end_date || trans.date == end_date)) {
-            if (trans.amount > 0) {
-                total_income += trans.amount;
-            } else {
-                total_expense += trans.amount;
-                expenses_by_category[trans.category] += trans.amount;
-            }
-        }
-    }
+    Report report = manager.generateReport(start_date, end_date);
 
     std::cout << "\n--- Report for " << start_date << " to " << end_date << " ---\n";
-    std::cout << "Total Income: " << total_income << std::endl;
-    std::cout << "Total Expense: " << total_expense << std::endl;
-    std::cout << "Net Balance: " << total_income + total_expense << std::endl;
+    std::cout << "Total Income: " << report.total_income << std::endl;
+    std::cout << "Total Expense: " << report.total_expense << std::endl;
+    std::cout << "Net Balance: " << report.total_income + report.total_expense << std::endl;
     std::cout << "\nExpenses by Category:\n";
-    if (expenses_by_category.empty()) {
+    if (report.expenses_by_category.empty()) {
         std::cout << "  No expenses in this period.\n";
     } else {
-        for (const auto& pair : expenses_by_category) {
+        for (const auto& pair : report.expenses_by_category) {
             std::cout << "  - " << pair.first << ": " << pair.second << std::endl;
         }
     }
@@ -138,9 +137,106 @@ void printMenu() {
     std::cout << "====================================\n";
 }
 
+#ifdef FINANCE_WITH_SERVER
+// --- Резидентный режим ---
+int runServer(const std::string& filename, const std::string& socket_path) {
+    FinanceManager manager;
+    try {
+        manager.loadFromFile(filename);
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading data: " << e.what() << std::endl;
+        return 1;
+    }
+
+    try {
+        RequestHandler handler(manager, filename);
+        Server server(handler, socket_path);
+        std::cerr << "Serving " << manager.getTransactions().size() << " transactions on "
+                  << socket_path << std::endl;
+        server.run();
+        std::cerr << "Data saved successfully to " << filename << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runClient(const std::string& socket_path, const std::vector<std::string>& fields) {
+    // Ответы печатаются по мере поступления; число запросов без ответа ограничено,
+    // чтобы не держать в памяти весь пакет со стандартного ввода.
+    const size_t kMaxInFlight = 1024;
+
+    int status = 0;
+    size_t in_flight = 0;
+    try {
+        Client client(socket_path);
+        auto receiveResponse = [&]() {
+            std::string response = client.receive();
+            if (response.compare(0, 3, "ERR") == 0) status = 1;
+            std::cout << response << '\n';
+            --in_flight;
+        };
+
+        if (fields.empty()) {
+            // Запросы построчно из стандартного ввода, отправляются конвейером.
+            std::string line;
+            while (std::getline(std::cin, line)) {
+                if (line.empty()) continue;
+                client.send(line);
+                if (++in_flight >= kMaxInFlight) {
+                    while (in_flight > kMaxInFlight / 2) receiveResponse();
+                }
+            }
+        } else {
+            std::string request = fields[0];
+            for (size_t i = 1; i < fields.size(); ++i) {
+                request += RequestHandler::kFieldSeparator;
+                request += fields[i];
+            }
+            client.send(request);
+            ++in_flight;
+        }
+
+        while (in_flight > 0) receiveResponse();
+    } catch (const std::exception& e) {
+        std::cout.flush();
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::cout.flush();
+    return status;
+}
+#endif
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <data_file.csv>" << std::endl;
+#ifdef FINANCE_WITH_SERVER
+    std::cerr << "       " << program << " serve <data_file.csv> <socket_path>" << std::endl;
+    std::cerr << "       " << program << " client <socket_path> [COMMAND [FIELD...]]" << std::endl;
+#endif
+}
+
 int main(int argc, char* argv[]) {
+#ifdef FINANCE_WITH_SERVER
+    if (argc >= 2 && std::string(argv[1]) == "serve") {
+        if (argc != 4) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return runServer(argv[2], argv[3]);
+    }
+    if (argc >= 2 && std::string(argv[1]) == "client") {
+        if (argc < 3) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return runClient(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+#endif
+
     if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <data_file.csv>" << std::endl;
+        printUsage(argv[0]);
         return 1;
     }
 
@@ -1,9 +1,24 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "FinanceManager.h"
+#include "RequestHandler.h"
+#include "TransactionSchema.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 #include <cstdio> // Для std::remove
 
+#ifdef FINANCE_WITH_SERVER
+#include "Client.h"
+#include "Server.h"
+#include <chrono>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
 // Помощник для создания менеджера и добавления некоторых данных
 FinanceManager create_test_manager() {
     FinanceManager manager;
@@ -40,10 +55,23 @@ TEST_CASE("Date Class Functionality") {
         CHECK_FALSE(d1 == d2);
     }
     
+    SUBCASE("fromChars") {
+        const std::string str = "2023-05-15";
+        CHECK(Date::fromChars(str.data(), str.data() + str.size()) == Date(2023, 5, 15));
+        const std::string trailing = "2023-05-15x";
+        CHECK_THROWS_AS(Date::fromChars(trailing.data(), trailing.data() + trailing.size()),
+                        std::invalid_argument);
+    }
+
     SUBCASE("Invalid date string") {
         CHECK_THROWS_AS(Date::fromString("2023/10/25"), std::invalid_argument);
         CHECK_THROWS_AS(Date::fromString("not-a-date"), std::invalid_argument);
         CHECK_THROWS_AS(Date::fromString("2023-13-01"), std::invalid_argument);
+        CHECK_THROWS_AS(Date::fromString("2024-02-01x"), std::invalid_argument);
+        CHECK_THROWS_AS(Date::fromString("2024-02"), std::invalid_argument);
+        CHECK_THROWS_AS(Date::fromString("-2147483648-01-01"), std::invalid_argument);
+        CHECK_THROWS_AS(Date::fromString("10000-01-01"), std::invalid_argument);
+        CHECK_THROWS_AS(Date::fromString("0-01-01"), std::invalid_argument);
     }
 }
 
@@ -67,6 +95,11 @@ TEST_CASE("FinanceManager Core Functionality") {
         CHECK(manager.findTransactionById(1) == nullptr);
         // Отрицательный случай: удалить несуществующее
         CHECK(manager.deleteTransaction(999) == false);
+        // Индекс остальных транзакций остаётся корректным после сдвига
+        REQUIRE(manager.findTransactionById(3) != nullptr);
+        CHECK(manager.findTransactionById(3)->category == "Transport");
+        CHECK(manager.editTransaction(2, Date(2023, 10, 26), 2100.0, "Salary", "Bonus"));
+        CHECK(manager.getTransactions()[0].amount == 2100.0);
     }
 
     SUBCASE("Edit Transaction") {
@@ -89,6 +122,178 @@ TEST_CASE("FinanceManager Core Functionality") {
         const auto* not_found = manager.findTransactionById(999);
         CHECK(not_found == nullptr);
     }
+
+    SUBCASE("Generate Report") {
+        Report report = manager.generateReport(Date(2023, 10, 25), Date(2023, 10, 26));
+        CHECK(report.total_income == doctest::Approx(2000.0));
+        CHECK(report.total_expense == doctest::Approx(-50.0));
+        REQUIRE(report.expenses_by_category.size() == 1);
+        CHECK(report.expenses_by_category["Food"] == doctest::Approx(-50.0));
+    }
+}
+
+bool isError(const std::string& response) {
+    return response.compare(0, 4, "ERR\t") == 0;
+}
+
+TEST_CASE("Server Request Protocol") {
+    const std::string test_filename = "test_server_data.csv";
+    std::remove(test_filename.c_str());
+
+    FinanceManager manager = create_test_manager();
+    RequestHandler handler(manager, test_filename);
+
+    SUBCASE("Add and Find") {
+        CHECK(handler.handle("ADD\t2023-11-01\t-100\tShopping\tNew shoes") == "OK\t4");
+        CHECK(handler.handle("FIND\t4") == "OK\t4\t2023-11-01\t-100\tShopping\tNew shoes");
+        CHECK(handler.handle("FIND\t999") == "ERR\tTransaction not found");
+    }
+
+    SUBCASE("Edit and Delete") {
+        CHECK(handler.handle("EDIT\t3\t2023-10-28\t-20\tTransport\tMetro") == "OK");
+        CHECK(manager.findTransactionById(3)->description == "Metro");
+        CHECK(handler.handle("DEL\t3") == "OK");
+        CHECK(manager.findTransactionById(3) == nullptr);
+        CHECK(handler.handle("DEL\t3") == "ERR\tTransaction not found");
+    }
+
+    SUBCASE("Report") {
+        CHECK(handler.handle("REPORT\t2023-10-01\t2023-10-31") ==
+              "OK\t2000\t-65.5\tFood\t-50\tTransport\t-15.5");
+        handler.handle("ADD\t2023-11-01\t1234567.89\tSalary\tBonus");
+        CHECK(handler.handle("REPORT\t2023-11-01\t2023-11-01") == "OK\t1234567.89\t0");
+    }
+
+    SUBCASE("Malformed requests") {
+        CHECK(isError(handler.handle("ADD\tnot-a-date\t1\tFood\t")));
+        CHECK(isError(handler.handle("FIND")));
+        CHECK(isError(handler.handle("NOPE")));
+        CHECK(isError(handler.handle("ADD\t2024-02-01\t12abc\tFood\tok")));
+        CHECK(isError(handler.handle("EDIT\t1x\t2024-02-01\t12\tFood\tok")));
+        CHECK(isError(handler.handle("DEL\t-1")));
+        CHECK(isError(handler.handle("FIND\t1 ")));
+        CHECK(isError(handler.handle("ADD\t2024-01-01\tnan\tFood\tx")));
+        CHECK(isError(handler.handle("ADD\t2024-01-01\tinf\tFood\tx")));
+        CHECK(isError(handler.handle("EDIT\t1\t2024-01-01\t-inf\tFood\tx")));
+        CHECK(handler.handle("REPORT\t2024-01-01\t2024-01-31") == "OK\t0\t0");
+        CHECK(isError(handler.handle("ADD")));
+        CHECK(isError(handler.handle("ADD\t2024-02-01\t-5\tFood")));
+        CHECK(isError(handler.handle("ADD\t2024-02-01\t-5\tFood\tok\textra")));
+        CHECK(isError(handler.handle("EDIT\t2024-02-01\t-5\tFood\tok")));
+        CHECK(manager.getTransactions().size() == 3);
+    }
+
+    SUBCASE("Text fields that would break the CSV") {
+        CHECK(isError(handler.handle("ADD\t2024-02-01\t-5\tFood\tCoffee, beans")));
+        CHECK(isError(handler.handle("ADD\t2024-02-01\t-5\tFood\r\tCoffee")));
+        CHECK(isError(handler.handle("EDIT\t1\t2023-10-25\t-50\tFood,Drinks\tLunch")));
+        CHECK(manager.getTransactions().size() == 3);
+        CHECK(manager.findTransactionById(1)->category == "Food");
+
+        CHECK(handler.handle("SAVE") == "OK");
+        FinanceManager reloaded;
+        CHECK_NOTHROW(reloaded.loadFromFile(test_filename));
+        CHECK(reloaded.getTransactions().size() == 3);
+    }
+
+    SUBCASE("Save and Shutdown") {
+        CHECK_FALSE(handler.shutdownRequested());
+        CHECK(handler.handle("SAVE") == "OK");
+        FinanceManager reloaded;
+        reloaded.loadFromFile(test_filename);
+        CHECK(reloaded.getTransactions().size() == 3);
+        CHECK(handler.handle("SHUTDOWN") == "OK");
+        CHECK(handler.shutdownRequested());
+    }
+
+    std::remove(test_filename.c_str());
+}
+
+TEST_CASE("Transaction Schema") {
+    Transaction trans = {7, Date(2024, 1, 9), -1234567.891, "Food", "Weekly groceries"};
+
+    SUBCASE("Header") {
+        CHECK(TransactionSchema::header<','>() == "ID,Date,Amount,Category,Description");
+    }
+
+    SUBCASE("Serialize and parse") {
+        std::string line;
+        TransactionSchema::appendDelimited<','>(line, trans);
+        CHECK(line == "7,2024-01-09,-1234567.891,Food,Weekly groceries");
+
+        Transaction parsed;
+        REQUIRE(TransactionSchema::parseDelimited<','>(line.data(), line.data() + line.size(),
+                                                       parsed));
+        CHECK(parsed.id == 7);
+        CHECK(parsed.date == trans.date);
+        CHECK(parsed.amount == trans.amount);
+        CHECK(parsed.category == "Food");
+        CHECK(parsed.description == "Weekly groceries");
+    }
+
+    SUBCASE("Extreme years") {
+        std::string line;
+        Transaction extreme = trans;
+        extreme.date = Date(-2147483647 - 1, 12, 31);
+        TransactionSchema::appendDelimited<','>(line, extreme);
+        CHECK(line == "7,-2147483648-12-31,-1234567.891,Food,Weekly groceries");
+
+        line.clear();
+        extreme.date = Date(9999, 12, 31);
+        TransactionSchema::appendDelimited<','>(line, extreme);
+        Transaction parsed;
+        REQUIRE(TransactionSchema::parseDelimited<','>(line.data(), line.data() + line.size(),
+                                                       parsed));
+        CHECK(parsed.date == Date(9999, 12, 31));
+    }
+
+    SUBCASE("Empty last field") {
+        const std::string line = "1,2023-10-10,100,Food,";
+        Transaction parsed;
+        REQUIRE(TransactionSchema::parseDelimited<','>(line.data(), line.data() + line.size(),
+                                                       parsed));
+        CHECK(parsed.description.empty());
+    }
+
+    SUBCASE("Column count mismatch") {
+        Transaction parsed;
+        const std::string too_few = "1,2023-10-10,100,Food";
+        CHECK_FALSE(TransactionSchema::parseDelimited<','>(
+            too_few.data(), too_few.data() + too_few.size(), parsed));
+        const std::string too_many = "1,2023-10-10,100,Food,a,b";
+        CHECK_FALSE(TransactionSchema::parseDelimited<','>(
+            too_many.data(), too_many.data() + too_many.size(), parsed));
+    }
+
+    SUBCASE("Text with separators") {
+        Transaction bad = trans;
+        bad.description = "Coffee, beans";
+        std::string line;
+        CHECK_THROWS_AS(TransactionSchema::appendDelimited<','>(line, bad), std::invalid_argument);
+        bad.description = "Tab\there";
+        CHECK_THROWS_AS(TransactionSchema::appendDelimited<'\t'>(line, bad), std::invalid_argument);
+
+        Transaction parsed;
+        const std::string tabbed = "1,2023-10-10,100,Food,Tab\there";
+        CHECK_THROWS_AS(TransactionSchema::parseDelimited<','>(
+                            tabbed.data(), tabbed.data() + tabbed.size(), parsed),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("Invalid value") {
+        Transaction parsed;
+        const std::string line = "1,2023-10-10,abc,Food,";
+        CHECK_THROWS_AS(TransactionSchema::parseDelimited<','>(line.data(),
+                                                               line.data() + line.size(), parsed),
+                        std::invalid_argument);
+    }
+
+    SUBCASE("Print") {
+        std::ostringstream os;
+        TransactionSchema::print(os, trans);
+        CHECK(os.str() == "ID: 7, Date: 2024-01-09, Amount: -1.23457e+06, Category: Food, "
+                          "Desc: Weekly groceries");
+    }
 }
 
 TEST_CASE("File I/O") {
@@ -119,6 +324,16 @@ TEST_CASE("File I/O") {
         // Проверка, правильно ли обновлен следующий идентификатор
         manager2.addTransaction(Date(2024, 1, 1), 1.0, "Test", "");
         CHECK(manager2.findTransactionById(4) != nullptr);
+
+        // Пустое описание и точная сумма переживают повторное сохранение
+        manager2.addTransaction(Date(2024, 1, 2), 1234567.89, "Test", "");
+        manager2.saveToFile(test_filename);
+        FinanceManager manager3;
+        manager3.loadFromFile(test_filename);
+        const auto* reloaded = manager3.findTransactionById(5);
+        REQUIRE(reloaded != nullptr);
+        CHECK(reloaded->amount == 1234567.89);
+        CHECK(reloaded->description.empty());
     }
 
     SUBCASE("Load from non-existent file") {
@@ -138,6 +353,206 @@ TEST_CASE("File I/O") {
         CHECK_THROWS_AS(manager.loadFromFile(test_filename), std::runtime_error);
     }
 
+    SUBCASE("Save refuses unreadable text and keeps the file") {
+        FinanceManager manager = create_test_manager();
+        manager.saveToFile(test_filename);
+        manager.addTransaction(Date(2024, 1, 1), -5.0, "Food", "Coffee, beans");
+        CHECK_THROWS_AS(manager.saveToFile(test_filename), std::runtime_error);
+
+        FinanceManager reloaded;
+        reloaded.loadFromFile(test_filename);
+        CHECK(reloaded.getTransactions().size() == 3);
+    }
+
+    SUBCASE("Load file with CRLF line endings") {
+        std::ofstream crlf_file(test_filename, std::ios::binary);
+        crlf_file << "ID,Date,Amount,Category,Description\r\n";
+        crlf_file << "1,2023-10-10,100,Food,Lunch\r\n";
+        crlf_file.close();
+
+        FinanceManager manager;
+        manager.loadFromFile(test_filename);
+        REQUIRE(manager.getTransactions().size() == 1);
+        CHECK(manager.getTransactions()[0].description == "Lunch");
+    }
+
+    SUBCASE("Load file with duplicate IDs") {
+        std::ofstream duplicate_file(test_filename);
+        duplicate_file << "ID,Date,Amount,Category,Description\n";
+        duplicate_file << "1,2023-10-10,100,Food,A\n";
+        duplicate_file << "1,2023-10-11,200,Food,B\n";
+        duplicate_file.close();
+
+        FinanceManager manager;
+        CHECK_THROWS_AS(manager.loadFromFile(test_filename), std::runtime_error);
+    }
+
     // Очистка после теста
     std::remove(test_filename.c_str());
 }
+
+#ifdef FINANCE_WITH_SERVER
+// Подключение без Client, чтобы управлять разбиением данных и не читать ответы.
+int connectRaw(const std::string& socket_path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    timeval timeout{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+std::string receiveRaw(int fd, size_t lines) {
+    std::string data;
+    char buffer[4096];
+    while (static_cast<size_t>(std::count(data.begin(), data.end(), '\n')) < lines) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) break;
+        data.append(buffer, static_cast<size_t>(received));
+    }
+    return data;
+}
+
+// Запускает Server::run в отдельном потоке; при выходе из области видимости
+// останавливает сервер запросом SHUTDOWN, если тест не сделал этого сам.
+struct ServerThread {
+    Server& server;
+    std::string socket_path;
+    std::thread thread;
+
+    ServerThread(Server& s, const std::string& path)
+        : server(s), socket_path(path), thread([this] { server.run(); }) {}
+
+    void shutdown() {
+        if (!thread.joinable()) return;
+        try {
+            Client client(socket_path);
+            client.send("SHUTDOWN");
+            client.receive();
+        } catch (const std::exception&) {
+        }
+        thread.join();
+    }
+
+    ~ServerThread() { shutdown(); }
+};
+
+TEST_CASE("Server over Unix socket") {
+    const std::string test_filename = "test_socket_data.csv";
+    const std::string socket_path = "/tmp/finance_test_" + std::to_string(getpid()) + ".sock";
+    std::remove(test_filename.c_str());
+
+    FinanceManager manager = create_test_manager();
+    RequestHandler handler(manager, test_filename);
+    Server server(handler, socket_path);
+    ServerThread running(server, socket_path);
+
+    SUBCASE("Pipelined requests") {
+        Client client(socket_path);
+        for (int i = 0; i < 300; ++i) {
+            client.send("FIND\t" + std::to_string(i % 3 + 1));
+        }
+        client.send("PING");
+        bool in_order = true;
+        for (int i = 0; i < 300; ++i) {
+            std::string response = client.receive();
+            std::string prefix = "OK\t" + std::to_string(i % 3 + 1) + "\t";
+            in_order = in_order && response.compare(0, prefix.size(), prefix) == 0;
+        }
+        CHECK(in_order);
+        CHECK(client.receive() == "OK");
+    }
+
+    SUBCASE("Pipelined batch larger than the server output limit") {
+        // ~200000 ответов FIND занимают около 10 МиБ, что намного больше предела
+        // неотправленных ответов сервера; клиент должен читать их во время отправки.
+        const int count = 200000;
+        Client client(socket_path);
+        for (int i = 0; i < count; ++i) {
+            client.send("FIND\t2");
+        }
+        client.flush();
+        int ok = 0;
+        for (int i = 0; i < count; ++i) {
+            if (client.receive().compare(0, 5, "OK\t2\t") == 0) ++ok;
+        }
+        CHECK(ok == count);
+    }
+
+    SUBCASE("Requests split across reads with CRLF") {
+        int fd = connectRaw(socket_path);
+        REQUIRE(fd >= 0);
+        const char* parts[] = {"FI", "ND\t2\r\nPI", "NG\r\n"};
+        for (const char* part : parts) {
+            send(fd, part, std::strlen(part), MSG_NOSIGNAL);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        CHECK(receiveRaw(fd, 2) == "OK\t2\t2023-10-26\t2000\tSalary\tOctober salary\nOK\n");
+        close(fd);
+    }
+
+    SUBCASE("Oversized request disconnects") {
+        int fd = connectRaw(socket_path);
+        REQUIRE(fd >= 0);
+        std::string oversized(128 * 1024, 'x');
+        send(fd, oversized.data(), oversized.size(), MSG_NOSIGNAL);
+        char buffer[16];
+        CHECK(recv(fd, buffer, sizeof(buffer), 0) <= 0);
+        close(fd);
+
+        Client client(socket_path);
+        client.send("PING");
+        CHECK(client.receive() == "OK");
+    }
+
+    SUBCASE("Shutdown saves before answering") {
+        Client client(socket_path);
+        client.send("ADD\t2024-02-01\t-5\tFood\tCoffee");
+        client.send("SHUTDOWN");
+        client.send("PING");
+        CHECK(client.receive() == "OK\t4");
+        CHECK(client.receive() == "OK");
+        CHECK(client.receive() == "ERR\tShutting down");
+        running.thread.join();
+
+        FinanceManager reloaded;
+        reloaded.loadFromFile(test_filename);
+        CHECK(reloaded.getTransactions().size() == 4);
+    }
+
+    SUBCASE("Client that never reads does not block shutdown") {
+        int fd = connectRaw(socket_path);
+        REQUIRE(fd >= 0);
+        std::string batch;
+        for (int i = 0; i < 4096; ++i) {
+            batch += "FIND\t1\n";
+        }
+        // Заполняем буферы, пока сервер не перестанет принимать запросы.
+        size_t total_sent = 0;
+        while (total_sent < 64 * 1024 * 1024) {
+            ssize_t sent = send(fd, batch.data(), batch.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (sent <= 0) break;
+            total_sent += static_cast<size_t>(sent);
+        }
+        CHECK(total_sent < 64 * 1024 * 1024);
+
+        Client client(socket_path);
+        client.send("SHUTDOWN");
+        CHECK(client.receive() == "OK");
+        running.thread.join();
+        close(fd);
+
+        FinanceManager reloaded;
+        reloaded.loadFromFile(test_filename);
+        CHECK(reloaded.getTransactions().size() == 3);
+    }
+
+    running.shutdown();
+    std::remove(test_filename.c_str());
+}
+#endif